@@ -0,0 +1,188 @@
+// Benchmark for color-symmetric canonical positions.
+// Build: gcc -std=c11 -Wall -Wextra -O2 -o bench_canon bench_canon.c bitops.c utils.c game.c
+// Run:   bench_canon [positions] [cache_entries]
+#include "game.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t rng_state = 0x2545F4914F6CDD1Dull;
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static double now_sec(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+// Random playouts from the opening; multi-jumps are continued at random.
+static size_t collect_positions(GameState* out, size_t n) {
+    size_t count = 0;
+    GameState g;
+    game_init(&g);
+    int plies = 0;
+    while (count < n) {
+        Move moves[64];
+        int m = generate_legal_moves(&g, moves, 64);
+        if (m == 0 || plies >= 150) { game_init(&g); plies = 0; continue; }
+        out[count++] = g;
+
+        Move mv = moves[rng_next() % (uint32_t)m];
+        if (!apply_move(&g, mv)) { game_init(&g); plies = 0; continue; }
+        while (mv.is_capture) {
+            Move caps[8];
+            int k = generate_captures_from(&g, mv.to, caps, 8);
+            if (k == 0) break;
+            mv = caps[rng_next() % (uint32_t)k];
+            if (!apply_move(&g, mv)) break;
+        }
+        g.turn = (g.turn == RED) ? BLACK : RED;
+        plies++;
+    }
+    return count;
+}
+
+// Every legal 2- and 3-piece position with both colors present, men or
+// kings, either side to move: a tiny endgame database. Men never stand
+// on their promotion rank and the side to move must have a move.
+static size_t enumerate_endgames(GameState* out, size_t max_out) {
+    int dark[32], k = 0;
+    for (int i = 0; i < 64; i++) if (((i / 8 + i % 8) & 1) == 1) dark[k++] = i;
+    size_t count = 0;
+    for (int pieces = 2; pieces <= 3; pieces++) {
+        int sq[3];
+        for (sq[0] = 0; sq[0] < 32; sq[0]++)
+        for (sq[1] = sq[0] + 1; sq[1] < 32; sq[1]++)
+        for (sq[2] = (pieces == 3 ? sq[1] + 1 : 0); sq[2] < (pieces == 3 ? 32 : 1); sq[2]++)
+        for (int colors = 1; colors < (1 << pieces) - 1; colors++)
+        for (int kings = 0; kings < (1 << pieces); kings++)
+        for (int turn = 0; turn < 2; turn++) {
+            if (count >= max_out) return count;
+            GameState g;
+            memset(&g, 0, sizeof(g));
+            for (int p = 0; p < pieces; p++) {
+                uint64_t bit = 1ull << dark[sq[p]];
+                if ((colors >> p) & 1) g.black |= bit; else g.red |= bit;
+                if ((kings >> p) & 1) g.kings |= bit;
+            }
+            g.turn = turn ? BLACK : RED;
+            if ((g.red & ~g.kings & RANK_8) || (g.black & ~g.kings & RANK_1)) continue;
+            if (check_winner(&g) >= 0) continue;
+            out[count++] = g;
+        }
+    }
+    return count;
+}
+
+static int same_state(const GameState* a, const GameState* b) {
+    return a->red == b->red && a->black == b->black && a->kings == b->kings && a->turn == b->turn;
+}
+
+// Open-addressing set of 64-bit keys; returns distinct count
+static size_t count_distinct(const uint64_t* keys, size_t n) {
+    size_t cap = 1;
+    while (cap < n * 2) cap <<= 1;
+    uint64_t* slots = calloc(cap, sizeof(uint64_t));
+    unsigned char* used = calloc(cap, 1);
+    if (!slots || !used) { free(slots); free(used); return 0; }
+    size_t distinct = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t j = (size_t)keys[i] & (cap - 1);
+        while (used[j] && slots[j] != keys[i]) j = (j + 1) & (cap - 1);
+        if (!used[j]) { used[j] = 1; slots[j] = keys[i]; distinct++; }
+    }
+    free(slots);
+    free(used);
+    return distinct;
+}
+
+// Direct-mapped cache over the key stream; returns hits
+static size_t cache_hits(const uint64_t* keys, size_t n, size_t entries) {
+    uint64_t* slots = calloc(entries, sizeof(uint64_t));
+    unsigned char* used = calloc(entries, 1);
+    if (!slots || !used) { free(slots); free(used); return 0; }
+    size_t hits = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t j = (size_t)(keys[i] % entries);
+        if (used[j] && slots[j] == keys[i]) hits++;
+        used[j] = 1;
+        slots[j] = keys[i];
+    }
+    free(slots);
+    free(used);
+    return hits;
+}
+
+static void run_set(const char* name, const char* note, const GameState* pos, size_t n, size_t cache) {
+    uint64_t* raw = malloc(n * sizeof(uint64_t));
+    uint64_t* canon = malloc(n * sizeof(uint64_t));
+    if (!raw || !canon) { printf("Out of memory.\n"); free(raw); free(canon); return; }
+
+    // sanity: mirror is an involution and keeps the move count
+    size_t bad = 0;
+    for (size_t i = 0; i < n; i += 97) {
+        GameState m, mm;
+        Move a[64], b[64];
+        game_mirror(&pos[i], &m);
+        game_mirror(&m, &mm);
+        if (!same_state(&mm, &pos[i])) bad++;
+        if (generate_legal_moves(&pos[i], a, 64) != generate_legal_moves(&m, b, 64)) bad++;
+        if (game_canonical_hash(&pos[i]) != game_canonical_hash(&m)) bad++;
+    }
+
+    uint64_t sink = 0;
+    double t0 = now_sec();
+    for (size_t i = 0; i < n; i++) raw[i] = game_hash(&pos[i]);
+    double t1 = now_sec();
+    for (size_t i = 0; i < n; i++) canon[i] = game_canonical_hash(&pos[i]);
+    double t2 = now_sec();
+    for (size_t i = 0; i < n; i++) {
+        GameState c;
+        game_canonical(&pos[i], &c);
+        sink += c.red;
+    }
+    double t3 = now_sec();
+
+    size_t d_raw = count_distinct(raw, n);
+    size_t d_canon = count_distinct(canon, n);
+    size_t h_raw = cache_hits(raw, n, cache);
+    size_t h_canon = cache_hits(canon, n, cache);
+
+    printf("== %s ==\n%s\n", name, note);
+    printf("positions:           %zu (sanity failures: %zu)\n", n, bad);
+    printf("game_hash:           %.2f ns/pos\n", (t1 - t0) * 1e9 / (double)n);
+    printf("game_canonical_hash: %.2f ns/pos\n", (t2 - t1) * 1e9 / (double)n);
+    printf("game_canonical:      %.2f ns/pos (%llu)\n", (t3 - t2) * 1e9 / (double)n,
+           (unsigned long long)(sink & 1));
+    printf("distinct raw:        %zu (%.1f MB at %zu B/entry)\n", d_raw,
+           (double)d_raw * sizeof(GameState) / 1e6, sizeof(GameState));
+    printf("distinct canonical:  %zu (%.1f%% of raw)\n", d_canon,
+           100.0 * (double)d_canon / (double)d_raw);
+    printf("cache %zu entries:   raw %.2f%% hits, canonical %.2f%% hits\n\n", cache,
+           100.0 * (double)h_raw / (double)n, 100.0 * (double)h_canon / (double)n);
+    free(raw);
+    free(canon);
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : 1000000;
+    size_t cache = (argc > 2) ? strtoull(argv[2], NULL, 10) : 65536;
+    if (n == 0 || cache == 0) { printf("usage: bench_canon [positions] [cache_entries]\n"); return 1; }
+
+    GameState* pos = malloc(n * sizeof(GameState));
+    if (!pos) { printf("Out of memory.\n"); return 1; }
+    run_set("random games",
+            "(measured gain: positions as they occur in play)",
+            pos, collect_positions(pos, n), cache);
+    run_set("2-3 piece endgames",
+            "(structural upper bound: both sides to move are enumerated, so\n"
+            " canonical keys halve this set by construction)",
+            pos, enumerate_endgames(pos, n), cache);
+    free(pos);
+    return 0;
+}
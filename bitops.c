@@ -75,4 +75,12 @@ void print_binary64(uint64_t value) {
 uint64_t bit_mask64(int pos) {
     if (pos < 0 || pos >= 64) return 0ull;
     return 1ull << pos;
+}
+
+uint64_t reverse_bits64(uint64_t value) {
+    value = __builtin_bswap64(value);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((value & 0x0F0F0F0F0F0F0F0Full) << 4);
+    value = ((value >> 2) & 0x3333333333333333ull) | ((value & 0x3333333333333333ull) << 2);
+    value = ((value >> 1) & 0x5555555555555555ull) | ((value & 0x5555555555555555ull) << 1);
+    return value;
 }
\ No newline at end of file
@@ -27,4 +27,7 @@ void     print_binary64(uint64_t value);
 
 uint64_t bit_mask64(int pos);
 
+// bit 0 <-> bit 63 (rotates a board 180 degrees)
+uint64_t reverse_bits64(uint64_t value);
+
 #endif // BITOPS_H
\ No newline at end of file
@@ -247,4 +247,41 @@ int check_winner(const GameState* g) {
         return (g->turn == RED) ? BLACK : RED;
     }
     return -1;
+}
+
+// splitmix64 finalizer
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27; x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t game_hash(const GameState* g) {
+    uint64_t h = mix64(g->red ^ 0x9E3779B97F4A7C15ull);
+    h = mix64(h ^ g->black);
+    h = mix64(h ^ g->kings);
+    return h ^ (g->turn == BLACK ? 0xD6E8FEB86659FD93ull : 0ull);
+}
+
+void game_mirror(const GameState* g, GameState* out) {
+    uint64_t red = g->red;
+    out->red   = reverse_bits64(g->black);
+    out->black = reverse_bits64(red);
+    out->kings = reverse_bits64(g->kings);
+    out->turn  = (g->turn == RED) ? BLACK : RED;
+}
+
+int game_canonical(const GameState* g, GameState* out) {
+    // g and its mirror always have opposite turns, so "Red to move"
+    // picks exactly one of them.
+    if (g->turn == RED) { *out = *g; return 0; }
+    game_mirror(g, out);
+    return 1;
+}
+
+uint64_t game_canonical_hash(const GameState* g) {
+    GameState c;
+    game_canonical(g, &c);
+    return game_hash(&c);
 }
\ No newline at end of file
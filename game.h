@@ -46,4 +46,18 @@ int check_winner(const GameState* g);
 // Util multi-jump detection
 int generate_captures_from(const GameState* g, int from_idx, Move* out, int max_out);
 
+// 64-bit position hash (pieces, kings and side to move)
+uint64_t game_hash(const GameState* g);
+
+// Color-reversed mirror: board rotated 180 degrees, red/black and turn
+// swapped. Both have the same value for the side to move.
+void game_mirror(const GameState* g, GameState* out);
+
+// One representative per mirror pair: the one with Red to move.
+// Returns 1 if out is the mirror of g.
+int game_canonical(const GameState* g, GameState* out);
+
+// Hash of the canonical form; equal for g and its mirror
+uint64_t game_canonical_hash(const GameState* g);
+
 #endif
\ No newline at end of file
@@ -1,8 +1,39 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "game.h"
 #include "ui.h"
+#include "save.h"
+#include "solver.h"
+
+// checkers --solve <file> [max_nodes]
+static int solve_file(const char* path, const char* max_nodes) {
+    GameState g;
+    if (load_game_from_file(&g, path) != 0) {
+        printf("Failed to load '%s'.\n", path);
+        return 1;
+    }
+    print_board(&g);
+
+    DfpnConfig cfg;
+    dfpn_default_config(&cfg);
+    if (max_nodes) cfg.max_nodes = strtoull(max_nodes, NULL, 10);
+    cfg.progress = dfpn_print_progress;
+
+    DfpnSolution sol;
+    if (dfpn_solve(&g, &cfg, &sol) != 0) {
+        printf("Out of memory.\n");
+        return 1;
+    }
+    dfpn_print_solution(&g, &sol);
+    return sol.result == DFPN_UNKNOWN ? 2 : 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && strcmp(argv[1], "--solve") == 0) {
+        return solve_file(argv[2], argc >= 4 ? argv[3] : NULL);
+    }
 
-int main(void) {
     GameState g;
     game_init(&g);
 
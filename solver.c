@@ -0,0 +1,506 @@
+#include "solver.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// phi/delta formulation: every node is seen from its side to move.
+// phi   = proof number  (side to move wins)
+// delta = disproof number (side to move does not win)
+#define DFPN_INF          100000000u
+#define DFPN_MAX_CHILDREN 64
+#define DFPN_MAX_HOPS     12
+#define DFPN_CLUSTER      4
+#define DFPN_MAX_PATH     512
+
+typedef struct {
+    uint64_t key;
+    uint64_t work;   // nodes spent below this entry; 0 = empty slot
+    uint32_t phi;
+    uint32_t delta;
+    int32_t min_depth;  // a horizon-limited "no win" holds at this depth or deeper
+    int32_t dist;       // plies to the win, once proven for the attacker
+} TTEntry;
+
+// Search value of a node, with the depth tag and win distance above.
+typedef struct {
+    uint32_t phi;
+    uint32_t delta;
+    int min_depth;
+    int dist;
+} NodeValue;
+
+typedef struct {
+    GameState after;
+    Move hops[DFPN_MAX_HOPS];
+    int nhops;
+} Ply;
+
+typedef struct {
+    TTEntry* table;
+    size_t mask;
+    const DfpnConfig* cfg;
+    Player attacker;
+    DfpnStats stats;
+    int aborted;
+    uint64_t node_limit;   // 0 = no limit
+    int max_depth;
+    int fit_dist;          // line extraction: wins must end within max_depth
+    uint64_t next_report;
+    int path_len;
+    uint64_t path[DFPN_MAX_PATH];
+    const uint64_t* frame_keys;  // children of the node being expanded
+    int frame_n;
+} Solver;
+
+// Finite values saturate below DFPN_INF so they never read as solved.
+static inline uint32_t cap_finite(uint64_t v) { return v >= DFPN_INF ? DFPN_INF - 1 : (uint32_t)v; }
+
+// --- move generation (whole plies) ---
+
+// Past max_out plies are counted but not stored.
+static int emit_ply(const GameState* g, const Move* hops, int nhops,
+                    GameState* out, Ply* plies, int n, int max_out) {
+    if (n >= max_out) return n + 1;
+    out[n] = *g;
+    out[n].turn = (g->turn == RED) ? BLACK : RED;
+    if (plies) {
+        plies[n].after = out[n];
+        memcpy(plies[n].hops, hops, sizeof(Move) * (size_t)nhops);
+        plies[n].nhops = nhops;
+    }
+    return n + 1;
+}
+
+static int expand_chain(const GameState* g, int from, Move* hops, int nhops,
+                        GameState* out, Ply* plies, int n, int max_out) {
+    Move caps[8];
+    int k = (nhops < DFPN_MAX_HOPS) ? generate_captures_from(g, from, caps, 8) : 0;
+    if (k == 0) return emit_ply(g, hops, nhops, out, plies, n, max_out);
+    for (int i = 0; i < k && n <= max_out; i++) {
+        GameState t = *g;
+        if (!apply_move(&t, caps[i])) continue;
+        hops[nhops] = caps[i];
+        n = expand_chain(&t, caps[i].to, hops, nhops + 1, out, plies, n, max_out);
+    }
+    return n;
+}
+
+// Successor positions of g; plies (optional) also receives the hops.
+// Returns -1 if there may be more than max_out. On dark squares a side
+// has at most 49 single steps (one per diagonal between them), but a
+// loaded position may use any square, and a king's multi-jumps can
+// branch at every landing square, so neither count stays below 64.
+static int generate_plies(const GameState* g, GameState* out, Ply* plies, int max_out) {
+    Move moves[64];
+    Move hops[DFPN_MAX_HOPS];
+    int m = generate_legal_moves(g, moves, 64);
+    if (m >= 64) return -1;   // moves[] may have been cut short
+    int n = 0;
+    for (int i = 0; i < m && n <= max_out; i++) {
+        GameState t = *g;
+        if (!apply_move(&t, moves[i])) continue;
+        hops[0] = moves[i];
+        if (moves[i].is_capture) n = expand_chain(&t, moves[i].to, hops, 1, out, plies, n, max_out);
+        else                     n = emit_ply(&t, hops, 1, out, plies, n, max_out);
+    }
+    return (n > max_out) ? -1 : n;
+}
+
+// --- node table ---
+
+static uint64_t node_key(const GameState* g) {
+    return game_hash(g);
+}
+
+static TTEntry* tt_find(Solver* s, uint64_t key) {
+    size_t base = (size_t)key & s->mask;
+    for (int i = 0; i < DFPN_CLUSTER; i++) {
+        TTEntry* e = &s->table[(base + (size_t)i) & s->mask];
+        if (e->work && e->key == key) return e;
+    }
+    return NULL;
+}
+
+// Drop the entries with the least work until the table is half full.
+// Small subtrees are cheap to re-derive; line extraction re-solves any
+// node it no longer finds.
+static void tt_gc(Solver* s) {
+    size_t cap = s->mask + 1;
+    size_t hist[65] = {0};
+    for (size_t i = 0; i < cap; i++) {
+        if (s->table[i].work) hist[64 - __builtin_clzll(s->table[i].work)]++;
+    }
+    size_t target = cap / 2;
+    size_t used = s->stats.entries_used;
+    int cutoff = 0;
+    while (cutoff < 64 && used > target) used -= hist[++cutoff];
+    for (size_t i = 0; i < cap; i++) {
+        TTEntry* e = &s->table[i];
+        if (e->work && (64 - __builtin_clzll(e->work)) <= cutoff) {
+            e->work = 0;
+            s->stats.entries_used--;
+            s->stats.gc_freed++;
+        }
+    }
+    s->stats.gc_runs++;
+}
+
+// Entries on the search path and siblings of the node being expanded
+// are never replaced, or two siblings sharing a cluster evict each other
+// on every store.
+static int tt_protected(const Solver* s, uint64_t key) {
+    for (int i = 0; i < s->path_len; i++) if (s->path[i] == key) return 1;
+    for (int i = 0; i < s->frame_n; i++) if (s->frame_keys[i] == key) return 1;
+    return 0;
+}
+
+static void tt_store(Solver* s, uint64_t key, const NodeValue* v, uint64_t work) {
+    if (work == 0) work = 1;
+    TTEntry* e = tt_find(s, key);
+    if (!e) {
+        if (s->stats.entries_used * 10 >= (s->mask + 1) * 9) tt_gc(s);
+        size_t base = (size_t)key & s->mask;
+        TTEntry* victim = NULL;
+        for (int i = 0; i < DFPN_CLUSTER; i++) {
+            TTEntry* c = &s->table[(base + (size_t)i) & s->mask];
+            if (!c->work) { victim = c; break; }
+            if (tt_protected(s, c->key)) continue;
+            if (!victim || c->work < victim->work) victim = c;
+        }
+        if (!victim) return;   // whole cluster in use by the search
+        if (victim->work == 0) s->stats.entries_used++;
+        e = victim;
+        e->key = key;
+        e->work = 0;
+    }
+    // two proofs of the same win: either length holds, keep the shorter
+    int dist = v->dist;
+    if (e->work && ((e->phi == 0 && v->phi == 0) || (e->delta == 0 && v->delta == 0)) && e->dist < dist)
+        dist = e->dist;
+    e->phi = v->phi;
+    e->delta = v->delta;
+    e->min_depth = v->min_depth;
+    e->dist = dist;
+    e->work += work;
+}
+
+// --- search ---
+
+static int attacker_wins(const Solver* s, const GameState* g, uint32_t phi, uint32_t delta) {
+    return (g->turn == s->attacker) ? (phi == 0) : (delta == 0);
+}
+
+static int attacker_fails(const Solver* s, const GameState* g, uint32_t phi, uint32_t delta) {
+    return (g->turn == s->attacker) ? (delta == 0) : (phi == 0);
+}
+
+// Past the horizon: no win for the attacker, valid at that depth only.
+static void horizon_value(const Solver* s, const GameState* g, int depth, NodeValue* v) {
+    if (g->turn == s->attacker) { v->phi = DFPN_INF; v->delta = 0; }
+    else                        { v->phi = 0; v->delta = DFPN_INF; }
+    v->min_depth = depth;
+    v->dist = 0;
+}
+
+// Table value of g at depth; a horizon-limited "no win" stored for a
+// deeper visit is only a first guess here, and so is a win too long
+// for the horizon while fit_dist is set.
+static int tt_value(Solver* s, const GameState* g, uint64_t key, int depth, NodeValue* v) {
+    TTEntry* e = tt_find(s, key);
+    if (!e) return 0;
+    v->min_depth = e->min_depth;
+    v->dist = e->dist;
+    if ((depth < e->min_depth && attacker_fails(s, g, e->phi, e->delta)) ||
+        (s->fit_dist && e->dist > s->max_depth - depth && attacker_wins(s, g, e->phi, e->delta))) {
+        v->phi = 1; v->delta = 1; v->min_depth = 0;
+    } else {
+        v->phi = e->phi; v->delta = e->delta;
+    }
+    return 1;
+}
+
+// Exact value of a finished game; returns 0 if g is still open.
+static int terminal_value(const GameState* g, NodeValue* v) {
+    int w = check_winner(g);
+    if (w < 0) return 0;
+    if (w == (int)g->turn) { v->phi = 0; v->delta = DFPN_INF; }
+    else                   { v->phi = DFPN_INF; v->delta = 0; }
+    v->min_depth = 0;
+    v->dist = 0;
+    return 1;
+}
+
+// Table lookup, evaluating terminal positions on a miss.
+static void lookup(Solver* s, const GameState* g, uint64_t key, int depth, NodeValue* v) {
+    if (tt_value(s, g, key, depth, v)) return;
+    if (!terminal_value(g, v)) {
+        v->phi = 1; v->delta = 1; v->min_depth = 0; v->dist = 0;
+        return;
+    }
+    tt_store(s, key, v, 1);
+}
+
+static void report(Solver* s) {
+    if (!s->cfg->progress || s->stats.nodes < s->next_report) return;
+    s->next_report = s->stats.nodes + s->cfg->progress_interval;
+    s->cfg->progress(&s->stats, s->cfg->progress_user);
+}
+
+static void mid(Solver* s, const GameState* g, uint64_t key, int depth,
+                uint32_t th_phi, uint32_t th_delta, NodeValue* out) {
+    s->stats.nodes++;
+    if (depth > s->stats.max_depth_seen) s->stats.max_depth_seen = depth;
+    report(s);
+
+    GameState kids[DFPN_MAX_CHILDREN];
+    uint64_t keys[DFPN_MAX_CHILDREN];
+    int n = generate_plies(g, kids, NULL, DFPN_MAX_CHILDREN);
+    out->min_depth = 0;
+    out->dist = 0;
+    if (n < 0) {
+        // a dropped move would make the verdict unsound: leave it open
+        s->stats.overflows++;
+        out->phi = 1; out->delta = 1;
+        return;
+    }
+    if (n == 0) {
+        out->phi = DFPN_INF; out->delta = 0;
+        tt_store(s, key, out, 1);
+        return;
+    }
+    for (int i = 0; i < n; i++) keys[i] = node_key(&kids[i]);
+
+    // Child values live in the frame as well as the table, so a child the
+    // table dropped keeps the value its last search returned.
+    NodeValue cv[DFPN_MAX_CHILDREN];
+    unsigned char fixed[DFPN_MAX_CHILDREN], stuck[DFPN_MAX_CHILDREN];
+    const uint64_t* outer_keys = s->frame_keys;
+    int outer_n = s->frame_n;
+    s->path[s->path_len++] = key;
+    s->frame_keys = keys;
+    s->frame_n = n;
+    for (int i = 0; i < n; i++) {
+        // a game that ends on the last allowed ply still counts
+        fixed[i] = (depth + 1 >= s->max_depth);
+        stuck[i] = 0;
+        if (!fixed[i]) lookup(s, &kids[i], keys[i], depth + 1, &cv[i]);
+        else if (!terminal_value(&kids[i], &cv[i])) horizon_value(s, &kids[i], depth + 1, &cv[i]);
+    }
+
+    uint64_t start_nodes = s->stats.nodes;
+    uint32_t phi = 0, delta = 0;
+    int best = -1;
+    for (;;) {
+        uint32_t max_phi = 0;
+        int open = 0;
+        uint32_t min_delta = DFPN_INF;
+        for (int i = 0; i < n; i++) {
+            if (!fixed[i] && cv[i].phi != 0 && cv[i].delta != 0) tt_value(s, &kids[i], keys[i], depth + 1, &cv[i]);
+            if (cv[i].phi > max_phi) max_phi = cv[i].phi;
+            if (cv[i].phi > 0) open++;
+            if (cv[i].delta < min_delta) min_delta = cv[i].delta;
+        }
+        phi = min_delta;
+        // weak proof numbers: max plus one per other open child. A plain
+        // sum double-counts transpositions and explodes in king endings.
+        if (max_phi >= DFPN_INF) delta = DFPN_INF;
+        else if (open == 0)      delta = 0;
+        else                     delta = cap_finite((uint64_t)max_phi + (uint64_t)(open - 1));
+        if (phi >= th_phi || delta >= th_delta || s->aborted) break;
+        if (s->node_limit && s->stats.nodes >= s->node_limit) { s->aborted = 1; break; }
+
+        // most promising child that still makes progress
+        best = -1;
+        for (int i = 0; i < n; i++) {
+            if (fixed[i] || stuck[i] || cv[i].delta >= DFPN_INF) continue;
+            if (best < 0 || cv[i].delta < cv[best].delta) best = i;
+        }
+        if (best < 0) break;
+        uint32_t delta2 = DFPN_INF;
+        for (int i = 0; i < n; i++) if (i != best && cv[i].delta < delta2) delta2 = cv[i].delta;
+
+        uint32_t child_th_phi = (th_delta >= DFPN_INF) ? DFPN_INF
+                              : cap_finite((uint64_t)th_delta - delta + cv[best].phi);
+        // 1+epsilon threshold (epsilon = 1/4) keeps sibling seesaws short
+        uint32_t child_th_delta = (delta2 >= DFPN_INF) ? DFPN_INF
+                                : cap_finite((uint64_t)delta2 + delta2 / 4 + 1);
+        if (th_phi < child_th_delta) child_th_delta = th_phi;
+        NodeValue r;
+        mid(s, &kids[best], keys[best], depth + 1, child_th_phi, child_th_delta, &r);
+        s->frame_keys = keys;
+        s->frame_n = n;
+        if (!s->aborted && r.phi == cv[best].phi && r.delta == cv[best].delta) stuck[best] = 1;
+        cv[best] = r;
+    }
+    s->path_len--;
+    s->frame_keys = outer_keys;
+    s->frame_n = outer_n;
+
+    // "No win" inherits the shallowest depth its horizon cut-offs allow;
+    // a win records its length for line extraction.
+    if (attacker_fails(s, g, phi, delta)) {
+        for (int i = 0; i < n; i++) {
+            if (!attacker_fails(s, &kids[i], cv[i].phi, cv[i].delta)) continue;
+            if (cv[i].min_depth - 1 > out->min_depth) out->min_depth = cv[i].min_depth - 1;
+        }
+    } else if (attacker_wins(s, g, phi, delta)) {
+        int attacking = (g->turn == s->attacker);
+        out->dist = attacking ? DFPN_MAX_PATH : 0;
+        for (int i = 0; i < n; i++) {
+            if (!attacker_wins(s, &kids[i], cv[i].phi, cv[i].delta)) continue;
+            if (attacking ? cv[i].dist < out->dist : cv[i].dist > out->dist) out->dist = cv[i].dist;
+        }
+        out->dist++;
+    }
+
+    // Solved for the side to move: the losing siblings of the winning
+    // child are not part of the proof, so make them the first to collect.
+    if (phi == 0) {
+        for (int i = 0; i < n; i++) {
+            TTEntry* e = (cv[i].delta == 0) ? NULL : tt_find(s, keys[i]);
+            if (e) e->work = 1;
+        }
+    }
+    out->phi = phi;
+    out->delta = delta;
+    tt_store(s, key, out, s->stats.nodes - start_nodes + 1);
+}
+
+// Search g with a fresh path until it is solved (root and line nodes).
+static void solve_node(Solver* s, const GameState* g, int depth, NodeValue* v) {
+    s->path_len = 0;
+    mid(s, g, node_key(g), depth, DFPN_INF, DFPN_INF, v);
+}
+
+// Follow the proof: the attacker plays the shortest win, the defender
+// the longest resistance. Stored distances are upper bounds, so the
+// horizon shrinks to the current bound as the line goes: "no win"
+// values stay valid, and re-solving a node whose short proof was
+// collected must find a win that fits, which the bound says exists.
+static void extract_line(Solver* s, const GameState* root, int dist, DfpnSolution* out) {
+    Ply plies[DFPN_MAX_CHILDREN];
+    GameState kids[DFPN_MAX_CHILDREN];
+    GameState g = *root;
+    int bound = dist;
+    int horizon = s->max_depth;
+    out->line_len = 0;
+    out->line_truncated = 1;
+    s->fit_dist = 1;
+
+    for (int ply = 0; ply < DFPN_MAX_PATH && !s->aborted; ply++) {
+        int n = generate_plies(&g, kids, plies, DFPN_MAX_CHILDREN);
+        if (n <= 0) { out->line_truncated = (n < 0); break; }
+        s->max_depth = (ply + bound < horizon) ? ply + bound : horizon;
+        int pick = -1;
+        int pick_dist = 0;
+        for (int pass = 0; pass < 2 && pick < 0 && !s->aborted; pass++) {
+            NodeValue v;
+            if (pass == 1) solve_node(s, &g, ply, &v);
+            for (int i = 0; i < n; i++) {
+                if (!tt_value(s, &kids[i], node_key(&kids[i]), ply + 1, &v) &&
+                    !terminal_value(&kids[i], &v)) continue;
+                if (!attacker_wins(s, &kids[i], v.phi, v.delta)) continue;
+                int better = (g.turn == s->attacker) ? (v.dist < pick_dist) : (v.dist > pick_dist);
+                if (pick < 0 || better) { pick = i; pick_dist = v.dist; }
+            }
+        }
+        if (pick < 0) break;
+        if (out->line_len + plies[pick].nhops > DFPN_MAX_LINE) break;
+        for (int h = 0; h < plies[pick].nhops; h++) {
+            out->line[out->line_len] = plies[pick].hops[h];
+            out->line_ply[out->line_len] = ply;
+            out->line_len++;
+        }
+        g = plies[pick].after;
+        bound = pick_dist;
+    }
+}
+
+void dfpn_default_config(DfpnConfig* cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->table_entries = (size_t)1 << 20;
+    cfg->max_nodes = 0;
+    cfg->max_depth = 200;
+    cfg->progress_interval = 1000000;
+    cfg->progress = NULL;
+    cfg->progress_user = NULL;
+}
+
+int dfpn_solve(const GameState* g, const DfpnConfig* cfg, DfpnSolution* out) {
+    DfpnConfig def;
+    if (!cfg) { dfpn_default_config(&def); cfg = &def; }
+    size_t cap = 64;
+    while (cap * 2 <= cfg->table_entries) cap *= 2;
+
+    Solver* s = calloc(1, sizeof(*s));
+    if (!s) return -1;
+    s->table = calloc(cap, sizeof(TTEntry));
+    if (!s->table) { free(s); return -1; }
+    s->mask = cap - 1;
+    s->cfg = cfg;
+    s->attacker = g->turn;
+    s->stats.capacity = cap;
+    s->next_report = cfg->progress_interval;
+    s->node_limit = cfg->max_nodes;
+    s->max_depth = cfg->max_depth;
+    if (s->max_depth < 1 || s->max_depth >= DFPN_MAX_PATH) s->max_depth = DFPN_MAX_PATH - 1;
+
+    memset(out, 0, sizeof(*out));
+    out->max_depth = s->max_depth;
+    NodeValue v;
+    solve_node(s, g, 0, &v);
+    if (v.phi == 0)        out->result = DFPN_PROVEN;
+    else if (v.delta == 0) out->result = DFPN_DISPROVEN;
+    else                   out->result = DFPN_UNKNOWN;
+    if (out->result == DFPN_PROVEN) {
+        // the line gets its own budget for re-solving collected nodes
+        if (cfg->max_nodes) s->node_limit = s->stats.nodes + cfg->max_nodes;
+        extract_line(s, g, v.dist, out);
+    }
+    out->stats = s->stats;
+    out->aborted = s->aborted;
+
+    free(s->table);
+    free(s);
+    return 0;
+}
+
+void dfpn_print_progress(const DfpnStats* s, void* user) {
+    (void)user;
+    printf("  nodes=%llu table=%zu/%zu gc=%llu depth=%d\n",
+           (unsigned long long)s->nodes, s->entries_used, s->capacity,
+           (unsigned long long)s->gc_runs, s->max_depth_seen);
+    fflush(stdout);
+}
+
+void dfpn_print_solution(const GameState* g, const DfpnSolution* sol) {
+    const char* side = (g->turn == RED) ? "Red" : "Black";
+    if (sol->result == DFPN_PROVEN)         printf("%s to move has a forced win.\n", side);
+    else if (sol->result == DFPN_DISPROVEN) printf("%s to move has no forced win within %d plies.\n", side, sol->max_depth);
+    else if (sol->aborted)                  printf("Unknown: node budget exhausted.\n");
+    else                                    printf("Unknown: search ended unsolved.\n");
+    if (sol->stats.overflows)
+        printf("%llu positions had more than %d moves and were left unsolved.\n",
+               (unsigned long long)sol->stats.overflows, DFPN_MAX_CHILDREN);
+    printf("nodes=%llu table=%zu/%zu gc=%llu\n",
+           (unsigned long long)sol->stats.nodes, sol->stats.entries_used,
+           sol->stats.capacity, (unsigned long long)sol->stats.gc_runs);
+    if (sol->result == DFPN_PROVEN && sol->line_truncated) {
+        if (sol->aborted) printf("Line incomplete: node budget exhausted.\n");
+        else              printf("Line incomplete: stopped after %d hops.\n", sol->line_len);
+    }
+    if (sol->line_len == 0) return;
+
+    printf("Line:");
+    for (int i = 0; i < sol->line_len; i++) {
+        char a[3], b[3];
+        coord_from_square_index(sol->line[i].from, a);
+        coord_from_square_index(sol->line[i].to, b);
+        int ply = sol->line_ply[i];
+        if (i > 0 && ply == sol->line_ply[i-1]) { printf("-%s", b); continue; }
+        if (ply % 2 == 0) printf(" %d.", ply / 2 + 1);
+        printf(" %s-%s", a, b);
+    }
+    printf("\n");
+}
@@ -0,0 +1,70 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+
+// Depth-first proof-number (df-pn) solver.
+// Proves whether the side to move in a position has a forced win.
+// A ply is one full turn: multi-jumps are followed to the end.
+// Repetitions are played out; lines longer than max_depth plies count
+// as "no win" for the side being proven. Such results are stored with
+// the depth they hold from, so both verdicts are exact for that horizon.
+
+typedef enum {
+    DFPN_PROVEN = 0,    // side to move has a forced win
+    DFPN_DISPROVEN = 1, // no forced win within max_depth plies
+    DFPN_UNKNOWN = 2    // unsolved (see DfpnSolution.aborted)
+} DfpnResult;
+
+typedef struct {
+    uint64_t nodes;        // mid() calls so far
+    size_t entries_used;   // occupied table slots
+    size_t capacity;       // table slots
+    uint64_t gc_runs;      // garbage collections
+    uint64_t gc_freed;     // entries released by gc
+    int max_depth_seen;    // deepest ply reached
+    uint64_t overflows;    // nodes left unsolved: too many moves to search
+} DfpnStats;
+
+typedef void (*DfpnProgressFn)(const DfpnStats* s, void* user);
+
+typedef struct {
+    size_t table_entries;        // node table size, rounded down to a power of two
+    uint64_t max_nodes;          // 0 = no limit
+    int max_depth;               // ply horizon
+    uint64_t progress_interval;  // nodes between progress callbacks
+    DfpnProgressFn progress;     // may be NULL
+    void* progress_user;
+} DfpnConfig;
+
+// Hops in the winning line: one per ply plus the extra hops of
+// multi-jumps, so the default horizon fits. Longer lines are cut and
+// flagged.
+#define DFPN_MAX_LINE 512
+
+typedef struct {
+    DfpnResult result;
+    DfpnStats stats;
+    int aborted;                 // node budget ran out
+    int max_depth;               // ply horizon the result holds for
+    int line_len;                // hops in line[]
+    int line_truncated;          // line[] stops before the game ends
+    Move line[DFPN_MAX_LINE];    // winning line, one entry per hop
+    int line_ply[DFPN_MAX_LINE]; // ply each hop belongs to (0 = root move)
+} DfpnSolution;
+
+void dfpn_default_config(DfpnConfig* cfg);
+
+// Solve g for its side to move. Returns 0 on success, -1 if the table
+// could not be allocated.
+int dfpn_solve(const GameState* g, const DfpnConfig* cfg, DfpnSolution* out);
+
+// Progress callback that prints one line of stats to stdout
+void dfpn_print_progress(const DfpnStats* s, void* user);
+
+// Print result and winning line in "c3-d4" notation
+void dfpn_print_solution(const GameState* g, const DfpnSolution* sol);
+
+#endif
@@ -0,0 +1,95 @@
+// Known-position checks for the df-pn solver.
+// Build: gcc -std=c11 -Wall -Wextra -O2 -o solver_check solver_check.c bitops.c utils.c game.c solver.c
+// Run:   solver_check   (exit status 1 if any check fails)
+#include "solver.h"
+#include <stdio.h>
+
+#define SQ(coord) (1ull << ((coord[1] - '1') * 8 + (coord[0] - 'a')))
+
+typedef struct {
+    const char* name;
+    GameState pos;
+    size_t table_entries;
+    uint64_t max_nodes;
+    int max_depth;       // 0 = default horizon
+    DfpnResult expect;
+} Check;
+
+static const char* result_name(DfpnResult r) {
+    if (r == DFPN_PROVEN) return "PROVEN";
+    if (r == DFPN_DISPROVEN) return "DISPROVEN";
+    return "UNKNOWN";
+}
+
+int main(void) {
+    const Check checks[] = {
+        { "trivial capture",
+          { SQ("c3"), SQ("d4"), 0, RED },
+          (size_t)1 << 16, 100000, 0, DFPN_PROVEN },
+        // wins that end exactly on the horizon
+        { "trivial capture, horizon 1",
+          { SQ("c3"), SQ("d4"), 0, RED },
+          (size_t)1 << 16, 100000, 1, DFPN_PROVEN },
+        { "2K vs 1K, horizon 5",
+          { SQ("c3") | SQ("d4"), SQ("g7"), SQ("c3") | SQ("d4") | SQ("g7"), RED },
+          (size_t)1 << 20, 5000000, 5, DFPN_PROVEN },
+        { "2K vs 1K, horizon 4",
+          { SQ("c3") | SQ("d4"), SQ("g7"), SQ("c3") | SQ("d4") | SQ("g7"), RED },
+          (size_t)1 << 20, 5000000, 4, DFPN_DISPROVEN },
+        { "K vs K",
+          { SQ("d1"), SQ("e8"), SQ("d1") | SQ("e8"), RED },
+          (size_t)1 << 20, 5000000, 0, DFPN_DISPROVEN },
+        { "2K vs 1K",
+          { SQ("c3") | SQ("d4"), SQ("g7"), SQ("c3") | SQ("d4") | SQ("g7"), RED },
+          (size_t)1 << 20, 5000000, 0, DFPN_PROVEN },
+        // 16 clusters for a ~250-node proof: constant replacement
+        { "2K vs 1K, 64-entry table",
+          { SQ("c3") | SQ("d4"), SQ("g7"), SQ("c3") | SQ("d4") | SQ("g7"), RED },
+          64, 5000000, 0, DFPN_PROVEN },
+        { "K vs K, 1024-entry table",
+          { SQ("d1"), SQ("e8"), SQ("d1") | SQ("e8"), RED },
+          1024, 5000000, 0, DFPN_DISPROVEN },
+        { "3K vs 2K",
+          { SQ("b1") | SQ("d1") | SQ("f1"), SQ("c8") | SQ("e8"),
+            SQ("b1") | SQ("d1") | SQ("f1") | SQ("c8") | SQ("e8"), RED },
+          (size_t)1 << 20, 20000000, 0, DFPN_PROVEN },
+        // kings on every square of ranks 2, 4, 6 and 8 have 97 moves:
+        // more than the solver searches, so it must not claim a result
+        { "97 moves",
+          { 0x7F00FF00FF00FF00ull, SQ("h8"), 0xFF00FF00FF00FF00ull, RED },
+          (size_t)1 << 12, 1000, 0, DFPN_UNKNOWN },
+    };
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); i++) {
+        const Check* c = &checks[i];
+        DfpnConfig cfg;
+        DfpnSolution sol;
+        dfpn_default_config(&cfg);
+        cfg.table_entries = c->table_entries;
+        cfg.max_nodes = c->max_nodes;
+        if (c->max_depth) cfg.max_depth = c->max_depth;
+        if (dfpn_solve(&c->pos, &cfg, &sol) != 0) {
+            printf("FAIL %-28s out of memory\n", c->name);
+            failures++;
+            continue;
+        }
+        int ok = (sol.result == c->expect);
+        // a proven result must come with a line that ends the game
+        if (ok && sol.result == DFPN_PROVEN) {
+            GameState g = c->pos;
+            if (sol.line_truncated) ok = 0;
+            for (int h = 0; h < sol.line_len; h++) {
+                if (!apply_move(&g, sol.line[h])) { ok = 0; break; }
+                int last = (h + 1 == sol.line_len) || sol.line_ply[h + 1] != sol.line_ply[h];
+                if (last) g.turn = (g.turn == RED) ? BLACK : RED;
+            }
+            if (check_winner(&g) != (int)c->pos.turn) ok = 0;
+        }
+        printf("%s %-28s %-9s (want %s) nodes=%llu gc=%llu\n", ok ? "ok  " : "FAIL",
+               c->name, result_name(sol.result), result_name(c->expect),
+               (unsigned long long)sol.stats.nodes, (unsigned long long)sol.stats.gc_runs);
+        if (!ok) failures++;
+    }
+    return failures ? 1 : 0;
+}
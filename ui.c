@@ -1,5 +1,6 @@
 #include "ui.h"
 #include "utils.h"
+#include "solver.h"
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
@@ -10,7 +11,7 @@ static void print_rank_border() {
 
 void print_legend(void) {
     printf("Legend: r=Red man, R=Red king, b=Black man, B=Black king\n");
-    printf("Enter moves as from-to (e.g., b6-a5 or c3-e5 for jumps). Use 'save <file>' or 'load <file>' or 'quit'.\n");
+    printf("Enter moves as from-to (e.g., b6-a5 or c3-e5 for jumps). Use 'save <file>', 'load <file>', 'solve' or 'quit'.\n");
 }
 
 void print_board(const GameState* g) {
@@ -102,6 +103,17 @@ int play_turn(GameState* g) {
             continue;
         }
 
+        if (strncmp(line, "solve", 5)==0) {
+            DfpnConfig cfg;
+            DfpnSolution sol;
+            dfpn_default_config(&cfg);
+            cfg.max_nodes = 5000000;
+            cfg.progress = dfpn_print_progress;
+            if (dfpn_solve(g, &cfg, &sol)==0) dfpn_print_solution(g, &sol);
+            else printf("Solver out of memory.\n");
+            continue;
+        }
+
         Move m;
         if (parse_move(line, &m) != 0) {
             printf("Could not parse. Try like 'b6-a5'.\n");